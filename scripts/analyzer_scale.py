@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Analyzer run time and peak RSS as the analyzer_test.cpp corpus grows.
+
+Generates translation units that each include analyzer_test.cpp several times, every copy in its
+own namespace (ANALYZER_TEST_NAMESPACE) and without main() (ANALYZER_TEST_NO_MAIN). It then runs
+gcc -fanalyzer and clang++ --analyze over them for each copy count K. If time per copy grows with K,
+the analyzer scales superlinearly; compare the rows before and after a toolchain upgrade.
+
+  python3 scripts/analyzer_scale.py --copies=1,2,4,8                 # K copies in one TU
+  python3 scripts/analyzer_scale.py --copies=8,16 --tus=4            # K copies split over 4 TUs
+  python3 scripts/analyzer_scale.py --copies=4 --generate-only       # Just write the TUs
+"""
+
+import argparse
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(REPO_ROOT, "analyzer_test.cpp")
+
+# Same flags as the analyzer commands in the analyzer_test.cpp header comment, but compile-only:
+# the copies have no main() and there is nothing to link.
+ANALYZERS = {
+    "gcc": ["g++", "-fanalyzer", "-c", "-o", os.devnull, "-pthread", "-Wall", "-Wextra"],
+    "clang": ["clang++", "--analyze", "-o", os.devnull, "-pthread", "-Wall", "-Wextra"],
+}
+
+
+def tu_source(copy_indices):
+    lines = [
+        "// Generated by scripts/analyzer_scale.py; do not edit.",
+        "#define ANALYZER_TEST_NO_MAIN 1",
+        "#define ANALYZER_ALLOC_HOOKS 0  // The replaced operator new/delete cannot live in a namespace",
+    ]
+    for i in copy_indices:
+        lines += [
+            "#define ANALYZER_TEST_NAMESPACE analyzer_copy_%d" % i,
+            '#include "%s"' % SOURCE,
+            "#undef ANALYZER_TEST_NAMESPACE",
+        ]
+    return "\n".join(lines) + "\n"
+
+
+def generate(out_dir, copies, tus):
+    """Writes K copies spread round-robin over min(tus, K) files and returns their paths."""
+    tus = max(1, min(tus, copies))
+    paths = []
+    for t in range(tus):
+        path = os.path.join(out_dir, "scale_k%d_tu%d.cpp" % (copies, t))
+        with open(path, "w") as f:
+            f.write(tu_source(range(t, copies, tus)))
+        paths.append(path)
+    return paths
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--copies", default="1,2,4,8", help="comma-separated copy counts K (default 1,2,4,8)")
+    parser.add_argument("--tus", type=int, default=1, help="split each K over this many TUs (default 1)")
+    parser.add_argument("--compilers", default="gcc,clang", help="subset of: " + ",".join(ANALYZERS))
+    parser.add_argument("--std", default="c++20,c++23", help="language modes (default c++20,c++23)")
+    parser.add_argument("--out-dir", default="analyzer_scale_out", help="where generated TUs are written")
+    parser.add_argument("--csv", help="also write the results table to this file")
+    parser.add_argument("--extra-flags", default="", help="appended to every analyzer command line")
+    parser.add_argument("--timeout", type=float, default=3600.0, help="seconds per analyzer run")
+    parser.add_argument("--generate-only", action="store_true", help="write the TUs and exit")
+    args = parser.parse_args()
+
+    copy_counts = sorted({int(k) for k in args.copies.split(",") if k})
+    if not copy_counts or copy_counts[0] < 1:
+        parser.error("--copies needs positive counts")
+    os.makedirs(args.out_dir, exist_ok=True)
+    tus_by_k = {k: generate(args.out_dir, k, args.tus) for k in copy_counts}
+    if args.generate_only:
+        for k in copy_counts:
+            print("K=%d: %s" % (k, " ".join(tus_by_k[k])))
+        return 0
+
+    csv_file = open(args.csv, "w", newline="") if args.csv else None
+    writer = csv.writer(csv_file) if csv_file else None
+    if writer:
+        writer.writerow(["compiler", "std", "copies", "tus", "wall_s", "peak_rss_mib", "per_copy_growth", "status"])
+    for name in args.compilers.split(","):
+        if name not in ANALYZERS:
+            parser.error("unknown compiler %r" % name)
+        base = ANALYZERS[name]
+        if shutil.which(base[0]) is None:
+            print("%s: %s not found, skipped" % (name, base[0]), file=sys.stderr)
+            continue
+        for std in args.std.split(","):
+            first_per_copy = None
+            for k in copy_counts:
+                total_wall = 0.0
+                peak_mib = 0.0
+                status = "ok"
+                detail = ""
+                for tu in tus_by_k[k]:
+                    cmd = base + ["-std=" + std] + args.extra_flags.split() + [tu]
+                    helper = [sys.executable, "-c", MEASURE_HELPER, str(args.timeout)] + cmd
+                    out = subprocess.run(helper, stdout=subprocess.PIPE, check=False).stdout.decode()
+                    run_status, wall, rss, tail = out.rstrip("\n").split("\t", 3)
+                    total_wall += float(wall)
+                    peak_mib = max(peak_mib, float(rss))
+                    if run_status != "ok":
+                        status, detail = run_status, tail
+                        break
+                per_copy = total_wall / k
+                if first_per_copy is None and status == "ok":
+                    first_per_copy = per_copy
+                growth = per_copy / first_per_copy if first_per_copy else 0.0
+                if writer:  # Row by row, so an interrupted sweep keeps what it measured
+                    writer.writerow([name, std, k, len(tus_by_k[k]), "%.2f" % total_wall, "%.1f" % peak_mib,
+                                     "%.2f" % growth, status])
+                    csv_file.flush()
+                print("%-6s %-6s K=%-4d tus=%-3d %9.2f s %9.1f MiB  per-copy x%.2f  %s%s"
+                      % (name, std, k, len(tus_by_k[k]), total_wall, peak_mib, growth, status,
+                         "  (" + detail + ")" if detail else ""))
+                sys.stdout.flush()
+    if csv_file:
+        csv_file.close()
+    return 0
+
+
+# Runs one analyzer command in a fresh interpreter. RUSAGE_CHILDREN is a maximum over all children
+# so far, so only a process of its own yields the peak RSS of this run alone. The driver (g++,
+# clang++) forks the real compiler, so a timeout kills the whole process group; the peak RSS of a
+# killed run only covers the driver.
+MEASURE_HELPER = """
+import os, resource, signal, subprocess, sys, time
+timeout, cmd = float(sys.argv[1]), sys.argv[2:]
+start = time.monotonic()
+proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, start_new_session=True)
+try:
+    _, err = proc.communicate(timeout=timeout)
+    status = "ok" if proc.returncode == 0 else "exit %d" % proc.returncode
+    lines = err.decode(errors="replace").strip().splitlines() if proc.returncode else []
+    tail = lines[-1] if lines else ""
+except subprocess.TimeoutExpired:
+    os.killpg(proc.pid, signal.SIGKILL)
+    proc.communicate()
+    status, tail = "timeout", "after %.0f s" % timeout
+wall = time.monotonic() - start
+rss_mib = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss / 1024.0
+print("%s\\t%.3f\\t%.1f\\t%s" % (status, wall, rss_mib, tail.replace("\\t", " ")))
+"""
+
+if __name__ == "__main__":
+    sys.exit(main())